@@ -18,4 +18,7 @@ CFile* OpenGlobalFile( MainWindow *mainWnd, const filePath& path, const filePath
 
 rw::Stream* RwStreamCreateTranslated( rw::Interface *rwEngine, CFile *stream );
 
+// Returns nullptr if the file cannot be memory-mapped.
+rw::Stream* RwStreamCreateMapped( rw::Interface *rwEngine, CFile *stream );
+
 #endif //_RENDERWARE_FILESYSTEM_STREAM_WRAP_
\ No newline at end of file
@@ -310,6 +310,9 @@ int main(int argc, char *argv[])
         rwEngine->SetCompatTransformNativeImaging( true );
         rwEngine->SetPreferPackedSampleExport( true );
 
+        // Only takes effect if the block regions are trusted (see the options dialog).
+        rwEngine->SetParallelTextureDeserialization( true );
+
         rwEngine->SetDXTRuntime( rw::DXTRUNTIME_SQUISH );
         rwEngine->SetPaletteRuntime( rw::PALRUNTIME_PNGQUANT );
 
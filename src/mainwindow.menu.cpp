@@ -27,6 +27,11 @@
 #include "massbuild.h"
 #include "massconvert.h"
 #include "massexport.h"
+#include "taskcompletionwindow.h"
+#ifdef _DEBUG
+// The codec benchmark is a developer tool.
+#include "tools/codecbench.h"
+#endif //_DEBUG
 
 struct mainWindowMenuEnv : public QObject, public magicThemeAwareItem
 {
@@ -211,6 +216,13 @@ struct mainWindowMenuEnv : public QObject, public magicThemeAwareItem
 
         connect( actionMassBuild, &QAction::triggered, this, &mainWindowMenuEnv::onRequestMassBuild );
 
+#ifdef _DEBUG
+        QAction *actionCodecBench = CreateMnemonicActionL( "Main.Tools.CodecBench", this );
+        toolsMenu->addAction(actionCodecBench);
+
+        connect( actionCodecBench, &QAction::triggered, this, &mainWindowMenuEnv::onRequestCodecBench );
+#endif //_DEBUG
+
         exportMenu = menu->addMenu("");
 
         // We should check if formats are available first :)
@@ -468,6 +480,9 @@ public slots:
     void onRequestMassConvert(bool checked);
     void onRequestMassExport(bool checked);
     void onRequestMassBuild(bool checked);
+#ifdef _DEBUG
+    void onRequestCodecBench(bool checked);
+#endif //_DEBUG
 
     void onToogleDarkTheme(bool checked);
     void onToogleLightTheme(bool checked);
@@ -1525,6 +1540,73 @@ void mainWindowMenuEnv::onRequestMassBuild(bool checked)
     TriggerHelperWidget( mainWnd, "mgbld_welcome", massbuild );
 }
 
+#ifdef _DEBUG
+
+struct GuiCodecBenchModule : public CodecBenchModule
+{
+    inline GuiCodecBenchModule( TaskCompletionWindow *taskWnd, rw::Interface *rwEngine ) : CodecBenchModule( rwEngine )
+    {
+        this->taskWnd = taskWnd;
+    }
+
+    void OnMessage( const rw::rwStaticString <wchar_t>& msg ) override
+    {
+        taskWnd->updateStatusMessage( wide_to_qt( msg ) );
+    }
+
+    rw::rwStaticString <wchar_t> TOKEN( const char *token ) override
+    {
+        return qt_to_widerw( MAGIC_TEXT(token) );
+    }
+
+    TaskCompletionWindow *taskWnd;
+};
+
+struct codecbench_task_params
+{
+    CodecBenchModule::run_config config;
+    TaskCompletionWindow *taskWnd;
+};
+
+static void codecbench_task_entry( rw::thread_t threadHandle, rw::Interface *engineInterface, void *ud )
+{
+    codecbench_task_params *params = (codecbench_task_params*)ud;
+
+    try
+    {
+        GuiCodecBenchModule module( params->taskWnd, engineInterface );
+
+        module.ApplicationMain( params->config );
+    }
+    catch( ... )
+    {
+        delete params;
+
+        throw;
+    }
+
+    delete params;
+}
+
+void mainWindowMenuEnv::onRequestCodecBench(bool checked)
+{
+    MainWindow *mainWnd = mainWindowMenuEnvRegister.get().GetBackResolve( this );
+
+    rw::Interface *rwEngine = mainWnd->GetEngine();
+
+    codecbench_task_params *params = new codecbench_task_params();
+
+    rw::thread_t taskThread = rw::MakeThread( rwEngine, codecbench_task_entry, params );
+
+    TaskCompletionWindow *taskWnd = new LogTaskCompletionWindow( mainWnd, taskThread, "Tools.CodecBench.TaskWndTitle", "Tools.CodecBench.TaskWndInitialText", 0 );
+
+    params->taskWnd = taskWnd;
+
+    rw::ResumeThread( rwEngine, taskThread );
+}
+
+#endif //_DEBUG
+
 void mainWindowMenuEnv::onRequestOpenWebsite(bool checked)
 {
     QDesktopServices::openUrl( QUrl( "http://www.gtamodding.com/wiki/Magic.TXD" ) );
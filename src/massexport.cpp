@@ -282,6 +282,9 @@ static void exporttask_runtime( rw::thread_t handle, rw::Interface *engineInterf
         engineInterface->SetWarningLevel( 0 );
         engineInterface->SetWarningManager( NULL );
 
+        // Load the texels of each texture only when it is exported.
+        engineInterface->SetLazyTextureLoading( true );
+
         // Run the application.
         MagicMassExportModule module( engineInterface, params->taskWnd );
 
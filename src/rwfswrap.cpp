@@ -71,7 +71,7 @@ struct rwFileSystemStreamWrapEnv
         CFile *theStream;
     };
 
-    struct eirFileSystemWrapperProvider : public rw::customStreamInterface, public rw::FileInterface
+    struct eirFileSystemWrapperProvider : public rw::customStreamInterface, public rw::FileInterface, public rw::FileMappingInterface
     {
         // *** rw::customStreamInterface IMPL
         void OnConstruct( rw::eStreamMode streamMode, void *userdata, void *membuf, size_t memSize ) const override
@@ -242,6 +242,71 @@ struct rwFileSystemStreamWrapEnv
             return theFile->Flush();
         }
 
+        // *** rw::FileMappingInterface IMPL.
+        mapPtr_t MapStream( filePtr_t ptr, void*& dataOut, size_t& dataSizeOut ) override
+        {
+            CFile *theFile = (CFile*)ptr;
+
+            fsOffsetNumber_t fileSize = theFile->GetSizeNative();
+
+            if ( fileSize <= 0 || (rw::uint64)fileSize > std::numeric_limits <size_t>::max() )
+            {
+                return nullptr;
+            }
+
+            CFileMappingProvider *mapping = nullptr;
+            void *mappedData = nullptr;
+
+            try
+            {
+                mapping = theFile->CreateMapping();
+
+                if ( mapping == nullptr )
+                {
+                    return nullptr;
+                }
+
+                // The texels are modified in-place, so we need private copy-on-write pages.
+                filemapAccessMode accessMode;
+                accessMode.allowRead = true;
+#ifdef _WIN32
+                // Copy-on-write views already allow writing, even for read-only files.
+                accessMode.allowWrite = false;
+#else
+                accessMode.allowWrite = true;
+#endif //_WIN32
+                accessMode.makePrivate = true;
+
+                mappedData = mapping->MapFileRegion( 0, (size_t)fileSize, accessMode );
+            }
+            catch( ... )
+            {
+                // We just fall back to regular reading.
+                mappedData = nullptr;
+            }
+
+            if ( mappedData == nullptr )
+            {
+                delete mapping;
+
+                return nullptr;
+            }
+
+            dataOut = mappedData;
+            dataSizeOut = (size_t)fileSize;
+
+            return (mapPtr_t)mapping;
+        }
+
+        void UnmapStream( mapPtr_t mapPtr, void *data ) override
+        {
+            CFileMappingProvider *mapping = (CFileMappingProvider*)mapPtr;
+
+            mapping->UnMapFileRegion( data );
+
+            delete mapping;
+        }
+
         CFileSystem *nativeFileSystem;
     };
 
@@ -331,6 +396,16 @@ rw::Stream* RwStreamCreateTranslated( rw::Interface *rwEngine, CFile *eirStream
     return result;
 }
 
+rw::Stream* RwStreamCreateMapped( rw::Interface *rwEngine, CFile *eirStream )
+{
+    // Our file interface handles are CFile pointers.
+    rw::streamConstructionFileHandleParam_t handleParam( eirStream );
+
+    rw::Stream *result = rwEngine->CreateStream( rw::RWSTREAMTYPE_MAPPED_HANDLE, rw::RWSTREAMMODE_READONLY, &handleParam );
+
+    return result;
+}
+
 static optional_struct_space <rw::interfacePluginStructRegister <rwFileSystemStreamWrapEnv, true>> rwFileSystemStreamWrapEnvRegister;
 
 void InitializeRWFileSystemWrap( void )
@@ -0,0 +1,450 @@
+/*****************************************************************************
+*
+*  PROJECT:     Magic.TXD
+*  LICENSE:     See LICENSE in the top level directory
+*  FILE:        src/tools/codecbench.cpp
+*  PURPOSE:     Texture codec benchmark tool.
+*
+*  Multi Theft Auto is available from http://www.multitheftauto.com/
+*  Project location: https://osdn.net/projects/magic-txd/
+*
+*****************************************************************************/
+
+#include "mainwindow.h"
+#include "codecbench.h"
+
+#include <sdk/NumericFormat.h>
+
+#include <chrono>
+#include <cmath>
+
+// The test images are generated the same way on every run, so that the results
+// of different builds and machines can be compared with each other.
+enum class eCodecBenchFixture
+{
+    GRADIENT,
+    WAVES,
+    CHECKER,
+    NOISE,
+    ALPHA_RAMP
+};
+
+static const eCodecBenchFixture _codecBenchFixtures[] =
+{
+    eCodecBenchFixture::GRADIENT,
+    eCodecBenchFixture::WAVES,
+    eCodecBenchFixture::CHECKER,
+    eCodecBenchFixture::NOISE,
+    eCodecBenchFixture::ALPHA_RAMP
+};
+
+static const char* GetCodecBenchFixtureName( eCodecBenchFixture fixture )
+{
+    switch( fixture )
+    {
+    case eCodecBenchFixture::GRADIENT:      return "gradient";
+    case eCodecBenchFixture::WAVES:         return "waves";
+    case eCodecBenchFixture::CHECKER:       return "checker";
+    case eCodecBenchFixture::NOISE:         return "noise";
+    case eCodecBenchFixture::ALPHA_RAMP:    return "alpha ramp";
+    }
+
+    return "unknown";
+}
+
+static rw::Bitmap MakeCodecBenchFixture( rw::Interface *rwEngine, eCodecBenchFixture fixture, rw::uint32 surfSize )
+{
+    const double maxCoord = (double)( std::max( surfSize, 2u ) - 1 );
+
+    rw::uint32 texelCount = ( surfSize * surfSize );
+
+    rw::rwStaticVector <rw::uint8> texels;
+    texels.Resize( (size_t)texelCount * 4 );
+
+    rw::uint32 randomSeed = 0x2545F491;
+
+    for ( rw::uint32 y = 0; y < surfSize; y++ )
+    {
+        for ( rw::uint32 x = 0; x < surfSize; x++ )
+        {
+            double u = ( x / maxCoord );
+            double v = ( y / maxCoord );
+
+            double red, green, blue, alpha = 1.0;
+
+            if ( fixture == eCodecBenchFixture::GRADIENT )
+            {
+                red = u;
+                green = v;
+                blue = ( 1.0 - ( u + v ) * 0.5 );
+            }
+            else if ( fixture == eCodecBenchFixture::WAVES )
+            {
+                // Smooth color changes of different frequencies, similar to photographic content.
+                red = ( 0.5 + 0.5 * sin( u * 13.0 + v * 3.0 ) );
+                green = ( 0.5 + 0.5 * sin( v * 21.0 - u * 5.0 ) );
+                blue = ( 0.5 + 0.5 * sin( ( u + v ) * 34.0 ) );
+            }
+            else if ( fixture == eCodecBenchFixture::CHECKER )
+            {
+                // Hard edges between saturated colors that do not line up with the 4x4 blocks.
+                bool isOdd = ( ( ( ( x + 2 ) / 6 ) + ( ( y + 1 ) / 6 ) ) % 2 != 0 );
+
+                red = ( isOdd ? 0.9 : 0.1 );
+                green = ( isOdd ? 0.2 : 0.7 );
+                blue = ( isOdd ? 0.1 : 0.95 );
+            }
+            else if ( fixture == eCodecBenchFixture::NOISE )
+            {
+                randomSeed = ( randomSeed * 1103515245u + 12345u );
+
+                red = ( ( randomSeed >> 8 ) & 0xFF ) / 255.0;
+                green = ( ( randomSeed >> 16 ) & 0xFF ) / 255.0;
+                blue = ( ( randomSeed >> 24 ) & 0xFF ) / 255.0;
+            }
+            else
+            {
+                red = ( 1.0 - v );
+                green = ( 0.5 + 0.5 * sin( u * 8.0 ) );
+                blue = v;
+                alpha = u;
+            }
+
+            rw::uint8 *texel = ( texels.GetData() + ( (size_t)y * surfSize + x ) * 4 );
+
+            texel[0] = (rw::uint8)( red * 255.0 + 0.5 );
+            texel[1] = (rw::uint8)( green * 255.0 + 0.5 );
+            texel[2] = (rw::uint8)( blue * 255.0 + 0.5 );
+            texel[3] = (rw::uint8)( alpha * 255.0 + 0.5 );
+        }
+    }
+
+    rw::Bitmap fixtureBitmap( rwEngine );
+
+    fixtureBitmap.setImageData(
+        texels.GetData(), rw::RASTER_8888, rw::COLOR_RGBA, 32, 4,
+        surfSize, surfSize, (rw::uint32)( texels.GetCount() )
+    );
+
+    return fixtureBitmap;
+}
+
+static double CalculateCodecBenchRMSE( const rw::Bitmap& srcBitmap, const rw::Bitmap& cmpBitmap, bool includeAlpha )
+{
+    rw::uint32 width = srcBitmap.getWidth();
+    rw::uint32 height = srcBitmap.getHeight();
+
+    double squaredErrorSum = 0;
+
+    for ( rw::uint32 y = 0; y < height; y++ )
+    {
+        for ( rw::uint32 x = 0; x < width; x++ )
+        {
+            rw::uint8 srcRed, srcGreen, srcBlue, srcAlpha;
+            rw::uint8 cmpRed, cmpGreen, cmpBlue, cmpAlpha;
+
+            srcBitmap.browsecolor( x, y, srcRed, srcGreen, srcBlue, srcAlpha );
+            cmpBitmap.browsecolor( x, y, cmpRed, cmpGreen, cmpBlue, cmpAlpha );
+
+            double redDiff = ( (double)srcRed - (double)cmpRed );
+            double greenDiff = ( (double)srcGreen - (double)cmpGreen );
+            double blueDiff = ( (double)srcBlue - (double)cmpBlue );
+
+            squaredErrorSum += ( redDiff * redDiff + greenDiff * greenDiff + blueDiff * blueDiff );
+
+            if ( includeAlpha )
+            {
+                double alphaDiff = ( (double)srcAlpha - (double)cmpAlpha );
+
+                squaredErrorSum += ( alphaDiff * alphaDiff );
+            }
+        }
+    }
+
+    double sampleCount = ( (double)width * height * ( includeAlpha ? 4 : 3 ) );
+
+    return sqrt( squaredErrorSum / sampleCount );
+}
+
+// Result of compressing one fixture with one runtime.
+struct codecBenchResult
+{
+    double megaTexelsPerSecond;
+    double rmse;
+    rw::rwStaticString <char> formatString;
+
+    // Raster of the last run, kept for further comparisons.
+    rw::RasterPtr compressedRaster;
+};
+
+// Runs the compression on fresh Direct3D9 rasters of the fixture and measures the fastest run.
+// The result of the last run is decompressed again to calculate the error.
+// Returns false if the compression callback reported a failure.
+template <typename compressCallbackType>
+static bool RunCodecBenchmark(
+    rw::Interface *rwEngine, const rw::Bitmap& fixtureBitmap, rw::uint32 repeatCount, bool includeAlpha,
+    const compressCallbackType& compressCallback, codecBenchResult& resultOut
+)
+{
+    typedef std::chrono::high_resolution_clock clock_t;
+
+    double bestSeconds = 0;
+
+    rw::RasterPtr compressedRaster;
+
+    for ( rw::uint32 n = 0; n < std::max( repeatCount, 1u ); n++ )
+    {
+        // Throws if the raster could not be created.
+        rw::RasterPtr benchRaster = rw::CreateRaster( rwEngine );
+
+        benchRaster->newNativeData( "Direct3D9" );
+        benchRaster->setImageData( fixtureBitmap );
+
+        clock_t::time_point startTime = clock_t::now();
+
+        bool success = compressCallback( benchRaster );
+
+        clock_t::time_point endTime = clock_t::now();
+
+        if ( success == false )
+        {
+            return false;
+        }
+
+        double seconds = std::chrono::duration <double> ( endTime - startTime ).count();
+
+        if ( n == 0 || seconds < bestSeconds )
+        {
+            bestSeconds = seconds;
+        }
+
+        compressedRaster = std::move( benchRaster );
+    }
+
+    double megaTexels = ( (double)fixtureBitmap.getWidth() * fixtureBitmap.getHeight() / 1000000.0 );
+
+    resultOut.megaTexelsPerSecond = ( bestSeconds > 0 ? ( megaTexels / bestSeconds ) : 0 );
+    resultOut.rmse = CalculateCodecBenchRMSE( fixtureBitmap, compressedRaster->getBitmap(), includeAlpha );
+
+    char formatBuf[ 128 ];
+    size_t formatLength = 0;
+
+    compressedRaster->getFormatString( formatBuf, sizeof( formatBuf ), formatLength );
+
+    resultOut.formatString.Clear();
+    resultOut.formatString.Append( formatBuf, std::min( formatLength, sizeof( formatBuf ) ) );
+
+    resultOut.compressedRaster = std::move( compressedRaster );
+
+    return true;
+}
+
+bool CodecBenchModule::ApplicationMain( const run_config& cfg )
+{
+    rw::Interface *rwEngine = this->rwEngine;
+
+    auto ansi_msg = [&]( const rw::rwStaticString <char>& msg )
+    {
+        this->OnMessage( CharacterUtil::ConvertStrings <char, wchar_t> ( msg ) );
+    };
+
+    auto report_result = [&]( const char *fixtureName, const char *codecName, const char *runtimeName, const codecBenchResult& result )
+    {
+        char lineBuf[ 256 ];
+
+        snprintf( lineBuf, sizeof( lineBuf ),
+            "%-10s %-5s %-9s %8.2f MP/s  RMSE %6.3f  [%s]\n",
+            fixtureName, codecName, runtimeName, result.megaTexelsPerSecond, result.rmse, result.formatString.GetConstString()
+        );
+
+        ansi_msg( lineBuf );
+    };
+
+    auto report_failure = [&]( const char *fixtureName, const char *codecName, const char *runtimeName )
+    {
+        ansi_msg(
+            rw::rwStaticString <char> ( fixtureName ) + " " + codecName + " " + runtimeName + ": failed\n"
+        );
+    };
+
+    auto report_exception = [&]( const char *fixtureName, const char *codecName, const char *runtimeName, rw::RwException& except )
+    {
+        report_failure( fixtureName, codecName, runtimeName );
+
+        this->OnMessage( L"  " + rw::DescribeException( rwEngine, except ) + L"\n" );
+    };
+
+    ansi_msg(
+        "* fixtureSize: " + eir::to_string <char, rw::RwStaticMemAllocator> ( cfg.fixtureSize ) + "\n" +
+        "* repeatCount: " + eir::to_string <char, rw::RwStaticMemAllocator> ( cfg.repeatCount ) + "\n\n"
+    );
+
+    // Keep the runtime selection local to the benchmark.
+    rw::StackedConfig_ApplyThreadConfig threadConfig( rwEngine );
+
+    struct dxtRuntimeInfo
+    {
+        rw::eDXTCompressionMethod method;
+        const char *name;
+    };
+
+    static const dxtRuntimeInfo dxtRuntimes[] =
+    {
+        { rw::DXTRUNTIME_NATIVE, "native" },
+        { rw::DXTRUNTIME_SQUISH, "squish" },
+        { rw::DXTRUNTIME_FAST, "fast" }
+    };
+
+    struct dxtFormatInfo
+    {
+        rw::eCompressionType compressionType;
+        const char *name;
+        bool hasAlpha;
+    };
+
+    static const dxtFormatInfo dxtFormats[] =
+    {
+        { rw::RWCOMPRESS_DXT1, "DXT1", false },
+        { rw::RWCOMPRESS_DXT3, "DXT3", true },
+        { rw::RWCOMPRESS_DXT5, "DXT5", true }
+    };
+
+    struct pvrRuntimeInfo
+    {
+        rw::ePVRCompressionMethod method;
+        const char *name;
+    };
+
+    static const pvrRuntimeInfo pvrRuntimes[] =
+    {
+        { rw::PVRRUNTIME_NATIVE, "native" },
+        { rw::PVRRUNTIME_PVRTEXLIB, "pvrtexlib" }
+    };
+
+    static constexpr size_t pvrRuntimeCount = countof( pvrRuntimes );
+
+    // PVRTexLib can be compiled in but still fail to load, so report the runtimes that cannot be benchmarked.
+    bool isPVRRuntimeAvailable[ pvrRuntimeCount ];
+
+    for ( size_t n = 0; n < pvrRuntimeCount; n++ )
+    {
+        const pvrRuntimeInfo& pvrRuntime = pvrRuntimes[ n ];
+
+        bool isAvailable = rwEngine->SetPVRRuntime( pvrRuntime.method );
+
+        if ( isAvailable == false )
+        {
+            ansi_msg( rw::rwStaticString <char> ( "* PVRTC runtime " ) + pvrRuntime.name + " is not available, skipping it\n" );
+        }
+
+        isPVRRuntimeAvailable[ n ] = isAvailable;
+    }
+
+    for ( eCodecBenchFixture fixture : _codecBenchFixtures )
+    {
+        const char *fixtureName = GetCodecBenchFixtureName( fixture );
+
+        rw::Bitmap fixtureBitmap = MakeCodecBenchFixture( rwEngine, fixture, cfg.fixtureSize );
+
+        for ( const dxtFormatInfo& dxtFormat : dxtFormats )
+        {
+            for ( const dxtRuntimeInfo& dxtRuntime : dxtRuntimes )
+            {
+                rwEngine->SetDXTRuntime( dxtRuntime.method );
+
+                try
+                {
+                    codecBenchResult result;
+
+                    RunCodecBenchmark( rwEngine, fixtureBitmap, cfg.repeatCount, dxtFormat.hasAlpha,
+                        [&]( rw::Raster *benchRaster )
+                    {
+                        benchRaster->compressCustom( dxtFormat.compressionType );
+
+                        return true;
+                    }, result );
+
+                    report_result( fixtureName, dxtFormat.name, dxtRuntime.name, result );
+                }
+                catch( rw::RwException& except )
+                {
+                    report_exception( fixtureName, dxtFormat.name, dxtRuntime.name, except );
+                }
+            }
+        }
+
+        // PVRTC compression of the embedded codec and, if it was compiled in, of PVRTexLib.
+        // The PowerVR native texture picks the PVRTC format depending on the fixture alpha.
+        rw::RasterPtr referenceRaster;
+
+        for ( size_t n = 0; n < pvrRuntimeCount; n++ )
+        {
+            if ( isPVRRuntimeAvailable[ n ] == false )
+                continue;
+
+            const pvrRuntimeInfo& pvrRuntime = pvrRuntimes[ n ];
+
+            rwEngine->SetPVRRuntime( pvrRuntime.method );
+
+            try
+            {
+                codecBenchResult result;
+
+                bool success =
+                    RunCodecBenchmark( rwEngine, fixtureBitmap, cfg.repeatCount, true,
+                        [&]( rw::Raster *benchRaster )
+                    {
+                        return rw::ConvertRasterTo( benchRaster, "PowerVR" );
+                    }, result );
+
+                if ( success )
+                {
+                    report_result( fixtureName, "PVRTC", pvrRuntime.name, result );
+
+                    if ( pvrRuntime.method == rw::PVRRUNTIME_PVRTEXLIB )
+                    {
+                        referenceRaster = std::move( result.compressedRaster );
+                    }
+                }
+                else
+                {
+                    report_failure( fixtureName, "PVRTC", pvrRuntime.name );
+                }
+            }
+            catch( rw::RwException& except )
+            {
+                report_exception( fixtureName, "PVRTC", pvrRuntime.name, except );
+            }
+        }
+
+        // Decode the PVRTexLib result with both decoders to see how closely the embedded decoder matches.
+        if ( referenceRaster.is_good() )
+        {
+            try
+            {
+                rw::Bitmap referenceDecoded = referenceRaster->getBitmap();
+
+                rwEngine->SetPVRRuntime( rw::PVRRUNTIME_NATIVE );
+
+                rw::Bitmap nativeDecoded = referenceRaster->getBitmap();
+
+                char lineBuf[ 256 ];
+
+                snprintf( lineBuf, sizeof( lineBuf ),
+                    "%-10s PVRTC decoder match       RMSE %6.3f\n",
+                    fixtureName, CalculateCodecBenchRMSE( referenceDecoded, nativeDecoded, true )
+                );
+
+                ansi_msg( lineBuf );
+            }
+            catch( rw::RwException& except )
+            {
+                report_exception( fixtureName, "PVRTC", "decoder match", except );
+            }
+        }
+
+        this->OnMessage( L"\n" );
+    }
+
+    return true;
+}
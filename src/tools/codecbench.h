@@ -0,0 +1,50 @@
+/*****************************************************************************
+*
+*  PROJECT:     Magic.TXD
+*  LICENSE:     See LICENSE in the top level directory
+*  FILE:        src/tools/codecbench.h
+*  PURPOSE:     Header of the texture codec benchmark tool.
+*
+*  Multi Theft Auto is available from http://www.multitheftauto.com/
+*  Project location: https://osdn.net/projects/magic-txd/
+*
+*****************************************************************************/
+
+#pragma once
+
+#include "shared.h"
+
+// Measures the throughput and the quality of the texture compression runtimes
+// on generated test images, so that builds and runtimes can be compared.
+struct CodecBenchModule abstract : public MessageReceiver
+{
+    struct run_config
+    {
+        // Width and height of the generated test images.
+        rw::uint32 fixtureSize = 512;
+
+        // Every compression is repeated this many times and the fastest run is reported.
+        rw::uint32 repeatCount = 3;
+    };
+
+    inline CodecBenchModule( rw::Interface *rwEngine )
+    {
+        this->rwEngine = rwEngine;
+    }
+
+    inline rw::Interface* GetEngine( void ) const
+    {
+        return rwEngine;
+    }
+
+    bool ApplicationMain( const run_config& cfg );
+
+    // We do not access any files.
+    CFile* WrapStreamCodec( CFile *compressed ) override
+    {
+        return compressed;
+    }
+
+private:
+    rw::Interface *rwEngine;
+};
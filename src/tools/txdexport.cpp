@@ -15,22 +15,15 @@
 
 #include "dirtools.h"
 
-static rw::TexDictionary* RwTexDictionaryStreamRead( rw::Interface *rwEngine, CFile *stream )
+static rw::TexDictionary* RwTexDictionaryStreamRead( rw::Interface *rwEngine, rw::Stream *rwStream )
 {
-    rw::TexDictionary *resultDict = nullptr;
+    rw::ObjectPtr rwObj = rwEngine->Deserialize( rwStream );
 
-    rw::StreamPtr rwStream = RwStreamCreateTranslated( rwEngine, stream );
+    rw::TexDictionary *resultDict = rw::ToTexDictionary( rwEngine, rwObj );
 
-    if ( rwStream.is_good() )
+    if ( resultDict )
     {
-        rw::ObjectPtr rwObj = rwEngine->Deserialize( rwStream );
-
-        resultDict = rw::ToTexDictionary( rwEngine, rwObj );
-
-        if ( resultDict )
-        {
-            rwObj.detach();
-        }
+        rwObj.detach();
     }
 
     return resultDict;
@@ -49,7 +42,8 @@ static void ExportImagesFromDictionary(
     {
         rw::TextureBase *texHandle = iter.Resolve();
 
-        if ( rw::Raster *texRaster = texHandle->GetRaster() )
+        // The texels are loaded from the TXD stream only now.
+        if ( rw::Raster *texRaster = texHandle->LoadRaster() )
         {
             // Construct the target filename.
             filePath targetFileName = relPathFromRoot;
@@ -106,6 +100,9 @@ static void ExportImagesFromDictionary(
                     }
                 }
             }
+
+            // We do not need the texels anymore, so only one texture is kept in memory at a time.
+            texHandle->SetRaster( nullptr );
         }
     }
 }
@@ -154,29 +151,35 @@ struct _discFileSentry_txdexport
 
                 buildRoot->GetRelativePathFromRoot( relPathFromRoot, false, relPathFromRootWithoutFile );
 
-                // For each texture that we find, export it as raw image.
-                rw::TexDictionary *texDict = RwTexDictionaryStreamRead( rwEngine, sourceStream );
+                // The textures load their texels from this stream, so it has to outlive the dictionary.
+                rw::StreamPtr rwStream = RwStreamCreateTranslated( rwEngine, sourceStream );
 
-                if ( texDict )
+                if ( rwStream.is_good() )
                 {
-                    try
-                    {
-                        // Export everything inside of this.
-                        ExportImagesFromDictionary(
-                            texDict, buildRoot, fileName, relPathFromRootWithoutFile, config->outputType,
-                            config->recImgFormat
-                        );
+                    // For each texture that we find, export it as raw image.
+                    rw::TexDictionary *texDict = RwTexDictionaryStreamRead( rwEngine, rwStream );
 
-                        anyWork = true;
-                    }
-                    catch( ... )
+                    if ( texDict )
                     {
-                        rwEngine->DeleteRwObject( texDict );
+                        try
+                        {
+                            // Export everything inside of this.
+                            ExportImagesFromDictionary(
+                                texDict, buildRoot, fileName, relPathFromRootWithoutFile, config->outputType,
+                                config->recImgFormat
+                            );
 
-                        throw;
-                    }
+                            anyWork = true;
+                        }
+                        catch( ... )
+                        {
+                            rwEngine->DeleteRwObject( texDict );
 
-                    rwEngine->DeleteRwObject( texDict );
+                            throw;
+                        }
+
+                        rwEngine->DeleteRwObject( texDict );
+                    }
                 }
             }
         }
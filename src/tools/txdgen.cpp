@@ -41,6 +41,7 @@ bool TxdGenModule::ProcessTXDArchive(
     bool generateMipmaps, rw::eMipmapGenerationMode mipGenMode, rw::uint32 mipGenMaxLevel,
     bool improveFiltering,
     bool doCompress, float compressionQuality,
+    bool sharedPalette,
     bool outputDebug, CFileTranslator *debugRoot,
     const rw::LibraryVersion& gameVersion,
     rw::rwStaticString <wchar_t>& errMsg
@@ -51,7 +52,13 @@ bool TxdGenModule::ProcessTXDArchive(
     bool hasProcessed = false;
 
     // Optimize the texture archive.
-    rw::StreamPtr txd_stream = RwStreamCreateTranslated( rwEngine, srcStream );
+    // If the file can be mapped then the texels are taken right from the mapping instead of being copied.
+    rw::StreamPtr txd_stream = RwStreamCreateMapped( rwEngine, srcStream );
+
+    if ( txd_stream.is_good() == false )
+    {
+        txd_stream = RwStreamCreateTranslated( rwEngine, srcStream );
+    }
 
     try
     {
@@ -124,13 +131,29 @@ bool TxdGenModule::ProcessTXDArchive(
                                 theTexture->fixFiltering();
                             }
 
+                            // If the texture is compressed anyway, we generate the mipmaps after compressing the base level.
+                            // Then every mipmap level is encoded right after it has been generated, instead of
+                            // encoding the whole uncompressed mipmap chain in another pass.
+                            // Debug output wants to see the mipmaps before compression, so it keeps the old order.
+                            bool generateEncodedMipmaps = ( generateMipmaps && doCompress && !outputDebug );
+
+                            rw::Bitmap mipmapBaseBitmap( rwEngine );
+
                             // Generate mipmaps on demand.
                             if ( generateMipmaps )
                             {
-                                // We generate as many mipmaps as we can.
-                                texRaster->generateMipmaps( mipGenMaxLevel + 1, mipGenMode );
+                                if ( generateEncodedMipmaps )
+                                {
+                                    // Keep the uncompressed base level to generate the mipmaps from.
+                                    mipmapBaseBitmap = texRaster->getBitmap();
+                                }
+                                else
+                                {
+                                    // We generate as many mipmaps as we can.
+                                    texRaster->generateMipmaps( mipGenMaxLevel + 1, mipGenMode );
 
-                                theTexture->fixFiltering();
+                                    theTexture->fixFiltering();
+                                }
                             }
 
                             // Output debug stuff.
@@ -245,6 +268,27 @@ bool TxdGenModule::ProcessTXDArchive(
                                 }
                             }
 
+                            if ( generateEncodedMipmaps )
+                            {
+                                rw::uint32 baseWidth, baseHeight;
+                                texRaster->getSize( baseWidth, baseHeight );
+
+                                rw::uint32 bitmapWidth, bitmapHeight;
+                                mipmapBaseBitmap.getSize( bitmapWidth, bitmapHeight );
+
+                                // The optimization could have resized the texture, then we have to use its own base level.
+                                if ( baseWidth == bitmapWidth && baseHeight == bitmapHeight )
+                                {
+                                    texRaster->generateMipmapsFromBitmap( mipmapBaseBitmap, mipGenMaxLevel + 1, mipGenMode );
+                                }
+                                else
+                                {
+                                    texRaster->generateMipmaps( mipGenMaxLevel + 1, mipGenMode );
+                                }
+
+                                theTexture->fixFiltering();
+                            }
+
                             // Improve the filtering mode if the user wants us to.
                             if ( improveFiltering )
                             {
@@ -263,6 +307,44 @@ bool TxdGenModule::ProcessTXDArchive(
                             }
                         }
                     }
+
+                    // Let all palettized textures share one palette per palette type.
+                    // Their native textures then carry the same CLUT.
+                    if ( sharedPalette )
+                    {
+                        rw::rwStaticVector <rw::Raster*> pal4Rasters;
+                        rw::rwStaticVector <rw::Raster*> pal8Rasters;
+
+                        for ( rw::TexDictionary::texIter_t iter = txd->GetTextureIterator(); !iter.IsEnd(); iter.Increment() )
+                        {
+                            rw::Raster *texRaster = iter.Resolve()->GetRaster();
+
+                            if ( texRaster == nullptr )
+                                continue;
+
+                            rw::ePaletteType paletteType = texRaster->getPaletteType();
+
+                            if ( paletteType == rw::PALETTE_4BIT )
+                            {
+                                pal4Rasters.AddToBack( texRaster );
+                            }
+                            else if ( paletteType == rw::PALETTE_8BIT )
+                            {
+                                pal8Rasters.AddToBack( texRaster );
+                            }
+                        }
+
+                        // A single raster keeps its own palette.
+                        if ( pal4Rasters.GetCount() > 1 )
+                        {
+                            rw::ConvertRastersToSharedPalette( rwEngine, pal4Rasters.GetData(), pal4Rasters.GetCount(), rw::PALETTE_4BIT );
+                        }
+
+                        if ( pal8Rasters.GetCount() > 1 )
+                        {
+                            rw::ConvertRastersToSharedPalette( rwEngine, pal8Rasters.GetData(), pal8Rasters.GetCount(), rw::PALETTE_8BIT );
+                        }
+                    }
                 }
                 catch( rw::RwException& except )
                 {
@@ -343,6 +425,7 @@ struct _discFileSentry_txdgen
     bool improveFiltering;
     bool doCompress;
     float compressionQuality;
+    bool sharedPalette;
     rw::LibraryVersion gameVersion;
     bool outputDebug;
     CFileTranslator *debugTranslator;
@@ -391,6 +474,7 @@ struct _discFileSentry_txdgen
                         this->generateMipmaps, this->mipGenMode, this->mipGenMaxLevel,
                         this->improveFiltering,
                         this->doCompress, this->compressionQuality,
+                        this->sharedPalette,
                         this->outputDebug, this->debugTranslator,
                         this->gameVersion,
                         errorMessage
@@ -565,6 +649,12 @@ TxdGenModule::run_config TxdGenModule::ParseConfig( CFileTranslator *root, const
                     cfg.c_compressionQuality = (float)mainEntry->GetFloat( "compressionQuality", 0.0 );
                 }
 
+                // Shared palette across a TXD.
+                if ( mainEntry->Find( "sharedPalette" ) )
+                {
+                    cfg.c_sharedPalette = mainEntry->GetBool( "sharedPalette" );
+                }
+
                 // Palette runtime type.
                 if ( const char *palRuntimeType = mainEntry->Get( "palRuntimeType" ) )
                 {
@@ -576,6 +666,10 @@ TxdGenModule::run_config TxdGenModule::ParseConfig( CFileTranslator *root, const
                     {
                         cfg.c_palRuntimeType = rw::PALRUNTIME_PNGQUANT;
                     }
+                    else if ( strieq( palRuntimeType, "mediancut" ) )
+                    {
+                        cfg.c_palRuntimeType = rw::PALRUNTIME_MEDIANCUT;
+                    }
                 }
 
                 // DXT compression method.
@@ -591,6 +685,10 @@ TxdGenModule::run_config TxdGenModule::ParseConfig( CFileTranslator *root, const
                     {
                         cfg.c_dxtRuntimeType = rw::DXTRUNTIME_SQUISH;
                     }
+                    else if ( strieq( dxtCompressionMethod, "fast" ) )
+                    {
+                        cfg.c_dxtRuntimeType = rw::DXTRUNTIME_FAST;
+                    }
                 }
 
                 // Warning level.
@@ -635,6 +733,12 @@ TxdGenModule::run_config TxdGenModule::ParseConfig( CFileTranslator *root, const
                     cfg.c_ignoreSerializationRegions = mainEntry->GetBool( "ignoreSerializationRegions" );
                 }
 
+                // Deserialize the textures of a TXD on multiple threads.
+                if ( mainEntry->Find( "parallelTXDLoading" ) )
+                {
+                    cfg.c_parallelTXDLoading = mainEntry->GetBool( "parallelTXDLoading" );
+                }
+
                 // Debug output flag.
                 if ( mainEntry->Find( "outputDebug" ) )
                 {
@@ -666,6 +770,7 @@ bool TxdGenModule::ApplicationMain( const run_config& cfg )
         // Set some configuration.
         rwEngine->SetPaletteRuntime( cfg.c_palRuntimeType );
         rwEngine->SetDXTRuntime( cfg.c_dxtRuntimeType );
+        rwEngine->SetParallelTextureDeserialization( cfg.c_parallelTXDLoading );
 
         // We inherit certain properties from Magic.TXD, so we do not want to set them here anymore.
 #if 0
@@ -801,6 +906,10 @@ bool TxdGenModule::ApplicationMain( const run_config& cfg )
             rw::rwStaticString <char> ( "* compressTextures: " ) + ( cfg.compressTextures ? "true" : "false" ) + "\n"
         );
 
+        ansi_msg(
+            rw::rwStaticString <char> ( "* sharedPalette: " ) + ( cfg.c_sharedPalette ? "true" : "false" ) + "\n"
+        );
+
         // TODO.
 #if 0
         ansi_msg(
@@ -820,6 +929,10 @@ bool TxdGenModule::ApplicationMain( const run_config& cfg )
         {
             strPalRuntimeType = "pngquant";
         }
+        else if ( actualPalRuntimeType == rw::PALRUNTIME_MEDIANCUT )
+        {
+            strPalRuntimeType = "mediancut";
+        }
 
         ansi_msg(
             rw::rwStaticString <char> ( "* palRuntimeType: " ) + strPalRuntimeType + "\n"
@@ -837,6 +950,10 @@ bool TxdGenModule::ApplicationMain( const run_config& cfg )
         {
             strDXTRuntimeType = "squish";
         }
+        else if ( actualDXTRuntimeType == rw::DXTRUNTIME_FAST )
+        {
+            strDXTRuntimeType = "fast";
+        }
 
         ansi_msg(
             rw::rwStaticString <char> ( "* dxtRuntimeType: " ) + strDXTRuntimeType + "\n"
@@ -870,6 +987,10 @@ bool TxdGenModule::ApplicationMain( const run_config& cfg )
             rw::rwStaticString <char> ( "* ignoreSerializationRegions: " ) + ( rwEngine->GetIgnoreSerializationBlockRegions() ? "true" : "false" ) + "\n"
         );
 
+        ansi_msg(
+            rw::rwStaticString <char> ( "* parallelTXDLoading: " ) + ( rwEngine->GetParallelTextureDeserialization() ? "true" : "false" ) + "\n"
+        );
+
         // Finish with a newline.
         this->OnMessage( L"\n" );
 
@@ -920,6 +1041,7 @@ bool TxdGenModule::ApplicationMain( const run_config& cfg )
                     sentry.improveFiltering = cfg.c_improveFiltering;
                     sentry.doCompress = cfg.compressTextures;
                     sentry.compressionQuality = cfg.c_compressionQuality;
+                    sentry.sharedPalette = cfg.c_sharedPalette;
                     sentry.gameVersion = targetVersion;
                     sentry.outputDebug = cfg.c_outputDebug;
                     sentry.debugTranslator = absDebugOutputTranslator;
@@ -46,6 +46,8 @@ public:
 
         bool compressTextures = false;
 
+        bool c_sharedPalette = false;
+
         rw::ePaletteRuntimeType c_palRuntimeType = rw::PALRUNTIME_PNGQUANT;
 
         rw::eDXTCompressionMethod c_dxtRuntimeType = rw::DXTRUNTIME_SQUISH;
@@ -59,6 +61,8 @@ public:
 
         bool c_ignoreSerializationRegions = true;
 
+        bool c_parallelTXDLoading = true;
+
         float c_compressionQuality = 1.0f;
 
         bool c_outputDebug = false;
@@ -78,6 +82,7 @@ public:
         bool generateMipmaps, rw::eMipmapGenerationMode mipGenMode, rw::uint32 mipGenMaxLevel,
         bool improveFiltering,
         bool doCompress, float compressionQuality,
+        bool sharedPalette,
         bool outputDebug, CFileTranslator *debugRoot,
         const rw::LibraryVersion& gameVersion,
         rw::rwStaticString <wchar_t>& errMsg